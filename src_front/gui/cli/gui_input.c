@@ -0,0 +1,150 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "gui_input.h"
+
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+
+long long input_now() {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (long long)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+void input_init(Input_decoder_t *decoder) {
+  decoder->state = input_ground;
+  decoder->start_us = 0;
+}
+
+/**
+ * @brief Converts the final byte of a sequence into the arrow key code.
+ *
+ * @param[in] byte The final byte of the sequence.
+ * @return The key code or ERR if the sequence is not an arrow.
+ */
+static int arrow_key(unsigned char byte) {
+  int ch = ERR;
+  if (byte == 'A')
+    ch = KEY_UP;
+  else if (byte == 'B')
+    ch = KEY_DOWN;
+  else if (byte == 'C')
+    ch = KEY_RIGHT;
+  else if (byte == 'D')
+    ch = KEY_LEFT;
+  return ch;
+}
+
+static int add_key(Input_key_t *keys, int count, int ch, long long start_us) {
+  if (ch != ERR) {
+    keys[count].ch = ch == S21_CR ? S21_ENTER : ch;
+    keys[count].start_us = start_us;
+    count++;
+  }
+  return count;
+}
+
+int input_feed(Input_decoder_t *decoder, unsigned char byte, long long now_us,
+               Input_key_t *keys) {
+  int count = 0;
+
+  if (decoder->state == input_esc) {
+    if (byte == '[') {
+      decoder->state = input_csi;
+      return 0;
+    }
+    if (byte == 'O') {
+      decoder->state = input_ss3;
+      return 0;
+    }
+    count = add_key(keys, count, S21_ESC, decoder->start_us);
+    decoder->state = input_ground;
+  } else if (decoder->state == input_csi) {
+    if (byte >= 0x20 && byte <= 0x3f) return 0;
+    decoder->state = input_ground;
+    if (byte >= 0x40 && byte <= 0x7e)
+      return add_key(keys, count, arrow_key(byte), decoder->start_us);
+  } else if (decoder->state == input_ss3) {
+    decoder->state = input_ground;
+    if (byte != S21_ESC)
+      return add_key(keys, count, arrow_key(byte), decoder->start_us);
+  }
+
+  if (byte == S21_ESC) {
+    decoder->state = input_esc;
+    decoder->start_us = now_us;
+  } else {
+    count = add_key(keys, count, byte, now_us);
+  }
+  return count;
+}
+
+int input_expire(Input_decoder_t *decoder, long long now_us,
+                 Input_key_t *keys) {
+  int count = 0;
+  long long waited_us = now_us - decoder->start_us;
+
+  if (decoder->state == input_esc &&
+      waited_us >= INPUT_ESC_TIMEOUT_MS * 1000LL) {
+    count = add_key(keys, count, S21_ESC, decoder->start_us);
+    decoder->state = input_ground;
+  } else if (decoder->state != input_ground && decoder->state != input_esc &&
+             waited_us >= INPUT_SEQ_TIMEOUT_MS * 1000LL) {
+    decoder->state = input_ground;
+  }
+  return count;
+}
+
+int input_timeout(const Input_decoder_t *decoder, long long now_us) {
+  long long timeout_us = INPUT_POLL_MS * 1000LL;
+  if (decoder->state == input_esc)
+    timeout_us = INPUT_ESC_TIMEOUT_MS * 1000LL;
+  else if (decoder->state != input_ground)
+    timeout_us = INPUT_SEQ_TIMEOUT_MS * 1000LL;
+
+  if (decoder->state != input_ground)
+    timeout_us -= now_us - decoder->start_us;
+  return timeout_us > 0 ? (int)((timeout_us + 999) / 1000) : 0;
+}
+
+int input_read(Input_decoder_t *decoder, int fd, Input_key_t *keys) {
+  struct pollfd pfd = {fd, POLLIN, 0};
+  unsigned char buf[INPUT_BUF_SIZE];
+  int count = 0;
+
+  if (poll(&pfd, 1, input_timeout(decoder, input_now())) > 0) {
+    ssize_t len = read(fd, buf, sizeof(buf));
+    long long now_us = input_now();
+    for (ssize_t i = 0; i < len; i++)
+      count += input_feed(decoder, buf[i], now_us, keys + count);
+  }
+  return count + input_expire(decoder, input_now(), keys + count);
+}
+
+Input_latency_t *get_latency() {
+  static Input_latency_t latency[INPUT_LATENCY_KEYS];
+  return latency;
+}
+
+void add_latency(Input_key_t key) {
+  Input_latency_t *latency = get_latency();
+  long long latency_us = input_now() - key.start_us;
+  int i = 0;
+
+  while (i < INPUT_LATENCY_KEYS - 1 && latency[i].count &&
+         latency[i].ch != key.ch)
+    i++;
+  latency[i].ch = key.ch;
+  latency[i].count++;
+  latency[i].total_us += latency_us;
+  if (latency_us > latency[i].max_us) latency[i].max_us = latency_us;
+}
+
+void print_latency(FILE *out) {
+  Input_latency_t *latency = get_latency();
+  for (int i = 0; i < INPUT_LATENCY_KEYS && latency[i].count; i++)
+    fprintf(out, "%-10s keys %5ld, avg %7lld us, max %7lld us\n",
+            keyname(latency[i].ch), latency[i].count,
+            latency[i].total_us / latency[i].count, latency[i].max_us);
+}
@@ -0,0 +1,155 @@
+/**
+ * @file gui_input.h
+ * @author agent@local
+ * @brief s21 tetris raw keyboard input decoder header
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef GUI_INPUT_H
+#define GUI_INPUT_H
+
+#include "gui_tetris.h"
+
+#define INPUT_ESC_TIMEOUT_MS 20
+#define INPUT_SEQ_TIMEOUT_MS 100
+#define INPUT_POLL_MS 100
+#define INPUT_BUF_SIZE 64
+#define INPUT_MAX_KEYS (INPUT_BUF_SIZE * 2 + 1)
+#define INPUT_LATENCY_KEYS 16
+
+/**
+ * @enum Input_state_t
+ * @brief Enum representing the states of the input decoder.
+ */
+typedef enum {
+  input_ground,  ///< No sequence is being decoded.
+  input_esc,     ///< Esc is received, it may be a bare key or a sequence.
+  input_csi,     ///< "Esc [" is received, waiting for the final byte.
+  input_ss3      ///< "Esc O" is received, waiting for the final byte.
+} Input_state_t;
+
+/**
+ * @struct Input_decoder_t
+ * @brief Structure to hold the state of the input decoder between reads.
+ *
+ * The state is kept between reads, so a sequence split across several reads
+ * is decoded the same way as a sequence received at once.
+ */
+typedef struct {
+  Input_state_t state;  ///< Current decoder state.
+  long long start_us;   ///< Arrival time of the first byte of the sequence.
+} Input_decoder_t;
+
+/**
+ * @struct Input_key_t
+ * @brief Structure to hold a decoded key.
+ */
+typedef struct {
+  int ch;              ///< Key code in terms of get_backend().
+  long long start_us;  ///< Arrival time of the first byte of the key.
+} Input_key_t;
+
+/**
+ * @struct Input_latency_t
+ * @brief Structure to hold the latency statistics of one key.
+ *
+ * The latency of a key is measured from the arrival of its first byte to
+ * the end of its processing, so for a bare Esc it includes the decoder
+ * timeout and lasts until the main loop exits.
+ */
+typedef struct {
+  int ch;              ///< Key code.
+  long count;          ///< Number of processed keys.
+  long long total_us;  ///< Total latency in microseconds.
+  long long max_us;    ///< Maximum latency in microseconds.
+} Input_latency_t;
+
+/**
+ * @brief Returns the monotonic time in microseconds.
+ *
+ * @return The current time in microseconds.
+ */
+long long input_now();
+
+/**
+ * @brief Resets the decoder to the initial state.
+ *
+ * @param[out] decoder A pointer to the decoder.
+ */
+void input_init(Input_decoder_t *decoder);
+
+/**
+ * @brief Passes one received byte to the decoder.
+ *
+ * Single byte keys are returned at once. "Esc [" and "Esc O" sequences are
+ * returned on their final byte, arrows are converted to the ncurses KEY_*
+ * codes, other sequences are dropped. An Esc followed by any other byte is
+ * returned as a bare Esc, and the byte is decoded as usual.
+ *
+ * @param[in,out] decoder A pointer to the decoder.
+ * @param[in] byte The received byte.
+ * @param[in] now_us Arrival time of the byte in microseconds.
+ * @param[out] keys Array for the decoded keys, at least 2 elements.
+ * @return The number of decoded keys.
+ */
+int input_feed(Input_decoder_t *decoder, unsigned char byte, long long now_us,
+               Input_key_t *keys);
+
+/**
+ * @brief Finishes a sequence that waits longer than its timeout.
+ *
+ * A pending Esc is returned as a bare Esc after INPUT_ESC_TIMEOUT_MS, an
+ * unfinished sequence is dropped after INPUT_SEQ_TIMEOUT_MS.
+ *
+ * @param[in,out] decoder A pointer to the decoder.
+ * @param[in] now_us Current time in microseconds.
+ * @param[out] keys Array for the decoded key, at least 1 element.
+ * @return The number of decoded keys.
+ */
+int input_expire(Input_decoder_t *decoder, long long now_us, Input_key_t *keys);
+
+/**
+ * @brief Calculates how long to wait for the next byte.
+ *
+ * @param[in] decoder A pointer to the decoder.
+ * @param[in] now_us Current time in microseconds.
+ * @return The timeout in milliseconds.
+ */
+int input_timeout(const Input_decoder_t *decoder, long long now_us);
+
+/**
+ * @brief Waits for the input and decodes all bytes received at once.
+ *
+ * @param[in,out] decoder A pointer to the decoder.
+ * @param[in] fd The file descriptor of the terminal.
+ * @param[out] keys Array for the decoded keys, INPUT_MAX_KEYS elements.
+ * @return The number of decoded keys.
+ */
+int input_read(Input_decoder_t *decoder, int fd, Input_key_t *keys);
+
+/**
+ * @brief Retrieves a pointer to the static latency statistics.
+ *
+ * @return A pointer to the array of INPUT_LATENCY_KEYS elements.
+ */
+Input_latency_t *get_latency();
+
+/**
+ * @brief Adds the latency of a processed key to the statistics.
+ *
+ * @param[in] key The processed key.
+ */
+void add_latency(Input_key_t key);
+
+/**
+ * @brief Prints the latency statistics for every processed key.
+ *
+ * @param[in] out The stream to print to.
+ */
+void print_latency(FILE *out);
+
+#endif  // GUI_INPUT_H
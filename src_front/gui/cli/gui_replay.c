@@ -0,0 +1,154 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "gui_replay.h"
+
+#include <string.h>
+#include <time.h>
+
+static const Replay_key_t replay_keys[] = {
+    {".", REPLAY_TICK}, {"enter", S21_ENTER}, {"left", KEY_LEFT},
+    {"right", KEY_RIGHT}, {"up", KEY_UP},      {"down", KEY_DOWN},
+    {"space", S21_SPACE}, {"p", 'p'},          {"P", 'P'},
+    {"esc", S21_ESC}};
+
+#define REPLAY_KEYS_COUNT (int)(sizeof(replay_keys) / sizeof(replay_keys[0]))
+
+FILE **get_record_file() {
+  static FILE *record = NULL;
+  return &record;
+}
+
+bool open_record(const char *path) {
+  FILE **record = get_record_file();
+  *record = fopen(path, "w");
+  return *record != NULL;
+}
+
+void close_record() {
+  FILE **record = get_record_file();
+  if (*record) fclose(*record);
+  *record = NULL;
+}
+
+void record_key(int ch) {
+  FILE *record = *get_record_file();
+  for (int i = 0; record && i < REPLAY_KEYS_COUNT; i++)
+    if (replay_keys[i].ch == ch) {
+      fprintf(record, "%s%c", replay_keys[i].token,
+              ch == REPLAY_TICK ? '\n' : ' ');
+      record = NULL;
+    }
+}
+
+int replay_key(const char *token) {
+  int ch = -1;
+  for (int i = 0; ch < 0 && i < REPLAY_KEYS_COUNT; i++)
+    if (!strcmp(replay_keys[i].token, token)) ch = replay_keys[i].ch;
+  return ch;
+}
+
+/**
+ * @brief Reads the next known key from the replay script.
+ *
+ * @param[in] script The opened replay script.
+ * @return The key code or EOF at the end of the script.
+ */
+static int next_scripted_key(FILE *script) {
+  char token[REPLAY_TOKEN_LEN];
+  int ch = -1;
+  while (ch < 0 && fscanf(script, "%15s", token) == 1) ch = replay_key(token);
+  return ch < 0 ? EOF : ch;
+}
+
+/**
+ * @brief Generates the next key of a pseudo-random session.
+ *
+ * Uses its own generator so that the session does not depend on how many
+ * times the backend calls rand(). Three of four keys are main loop ticks.
+ *
+ * @return The key code.
+ */
+static int next_random_key() {
+  static const int keys[] = {S21_ENTER, KEY_LEFT,  KEY_RIGHT, KEY_LEFT,
+                             KEY_RIGHT, KEY_UP,    S21_SPACE, KEY_DOWN};
+  static unsigned int seed = BENCH_SEED;
+  seed = seed * 1103515245u + 12345u;
+  unsigned int value = (seed >> 16) & 0x7fff;
+  return value % 4 ? REPLAY_TICK : keys[(value >> 2) % 8];
+}
+
+static double elapsed(struct timespec start, struct timespec end) {
+  return (double)(end.tv_sec - start.tv_sec) +
+         (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+int bench(const char *path, long ticks) {
+  FILE *script = NULL;
+  if (path && !(script = fopen(path, "r"))) {
+    fprintf(stderr, "bench: cannot open %s\n", path);
+    return 1;
+  }
+
+  FILE *out = tmpfile();
+  FILE *in = fopen("/dev/null", "r");
+  const char *term = getenv("TERM");
+  SCREEN *screen = NULL;
+  if (out && in)
+    screen = newterm(term && *term ? term : "xterm-256color", out, in);
+  if (!screen) {
+    fprintf(stderr, "bench: cannot create headless terminal\n");
+    if (script) fclose(script);
+    if (out) fclose(out);
+    if (in) fclose(in);
+    return 1;
+  }
+
+  cbreak();
+  noecho();
+  curs_set(0);
+  if (has_colors()) start_color();
+  init_colors(false);
+  srand(BENCH_SEED);
+  refresh();
+  create_wins();
+  fflush(out);
+  long start_bytes = ftell(out);
+
+  long done = 0, frames = 0, pass_ticks = 0;
+  struct timespec start, end;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  while (done < ticks) {
+    int ch = script ? next_scripted_key(script) : next_random_key();
+    if (ch == EOF || ch == S21_ESC) {
+      if (!pass_ticks) break;
+      rewind(script);
+      pass_ticks = 0;
+    } else if (ch == REPLAY_TICK) {
+      update_wins();
+      done++;
+      pass_ticks++;
+      frames++;
+    } else if (get_backend(ch)) {
+      update_wins();
+      frames++;
+    }
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  fflush(out);
+  long bytes = ftell(out) - start_bytes;
+
+  delete_wins();
+  endwin();
+  delscreen(screen);
+  fclose(out);
+  fclose(in);
+  if (script) fclose(script);
+
+  double seconds = elapsed(start, end);
+  printf("%s: ticks %ld, frames %ld, %.3f s, ticks/s %.0f, render bytes %ld, "
+         "bytes/frame %.1f\n",
+         path ? path : "random", done, frames, seconds,
+         seconds > 0 ? done / seconds : 0.0, bytes,
+         frames ? (double)bytes / frames : 0.0);
+  return 0;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file gui_replay.h
+ * @author agent@local
+ * @brief s21 tetris session recording and headless replay header
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef GUI_REPLAY_H
+#define GUI_REPLAY_H
+
+#include <stdio.h>
+
+#include "gui_tetris.h"
+
+#define REPLAY_TICK 0
+#define REPLAY_TOKEN_LEN 16
+
+#define BENCH_TICKS 20000
+#define BENCH_SEED 21
+
+/**
+ * @struct Replay_key_t
+ * @brief Maps a replay script token to the key code it stands for.
+ *
+ * A replay script is a whitespace separated list of tokens. Every key token
+ * is passed to get_backend() the same way key_listener() does it, and the
+ * `.` token (REPLAY_TICK) stands for one iteration of the main loop.
+ */
+typedef struct {
+  const char *token;  ///< Token as written in the script.
+  int ch;             ///< Key code passed to get_backend().
+} Replay_key_t;
+
+/**
+ * @brief Retrieves a pointer to the static session record file.
+ *
+ * The pointer is NULL unless recording was enabled with open_record().
+ *
+ * @return A pointer to the static record FILE pointer.
+ */
+FILE **get_record_file();
+
+/**
+ * @brief Starts recording the session into the file at the given path.
+ *
+ * @param[in] path Path of the replay script to write.
+ * @return Returns true if the file was opened, otherwise returns false.
+ */
+bool open_record(const char *path);
+
+/**
+ * @brief Stops recording the session and closes the record file.
+ */
+void close_record();
+
+/**
+ * @brief Appends the token of the given key to the record file.
+ *
+ * Does nothing if recording is disabled or the key has no token.
+ *
+ * @param[in] ch The processed key code or REPLAY_TICK for a main loop tick.
+ */
+void record_key(int ch);
+
+/**
+ * @brief Converts a replay script token into the key code.
+ *
+ * @param[in] token The token read from the script.
+ * @return The key code, REPLAY_TICK for `.` or -1 for an unknown token.
+ */
+int replay_key(const char *token);
+
+/**
+ * @brief Runs a headless session and prints the render statistics.
+ *
+ * The windows are drawn into a temporary file instead of the terminal and the
+ * main loop is run without delays. The script is replayed from the start
+ * every time it ends or reaches the Esc key, until the requested number of
+ * ticks is made. Without a script a pseudo-random session with a fixed seed
+ * is played. Prints the number of ticks, ticks per second and the number of
+ * bytes ncurses has written to the terminal.
+ *
+ * @param[in] path Path of the replay script or NULL for a random session.
+ * @param[in] ticks The number of main loop ticks to make.
+ * @return Returns 0 on success, otherwise returns 1.
+ */
+int bench(const char *path, long ticks);
+
+#endif  // GUI_REPLAY_H
@@ -1,6 +1,24 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include "gui_tetris.h"
 
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "gui_input.h"
+#include "gui_replay.h"
+
 int main(int argc, char *argv[]) {
+  if (argc > 1 && !strcmp(argv[1], "--bench")) {
+    long ticks = argc > 3 ? atol(argv[3]) : 0;
+    return bench(argc > 2 && *argv[2] ? argv[2] : NULL,
+                 ticks > 0 ? ticks : BENCH_TICKS);
+  }
+
+  if (argc > 3 && *argv[3] && !open_record(argv[3]))
+    fprintf(stderr, "record: cannot open %s\n", argv[3]);
+
   WIN_INIT;
   if (argc == 1 || (argc > 1 && *argv[1] != '0'))
     start_color(); 
@@ -13,12 +31,16 @@ int main(int argc, char *argv[]) {
   else
     init_colors(false);
 
+  bool latency = argc > 4 && *argv[4] == '1';
+
   refresh();
 
   create_wins();
   loop();
   delete_wins();
   endwin();
+  close_record();
+  if (latency) print_latency(stdout);
 
   return 0;
 }
@@ -72,12 +94,48 @@ void create_wins() {
 
 void loop() {
   pthread_t thread;
-  Thread_args_t args = {true};
+  Thread_args_t args = {.running = true, .mutex = PTHREAD_MUTEX_INITIALIZER};
+  pthread_condattr_t attr;
+
+  pthread_condattr_init(&attr);
+  pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+  pthread_cond_init(&args.wake, &attr);
+  pthread_condattr_destroy(&attr);
 
   pthread_create(&thread, NULL, key_listener, &args);
-  while (args.running) napms((14 - update_wins()) * 50);
+  while (args.running) {
+    record_key(REPLAY_TICK);
+    wait_tick(&args, (14 - update_wins()) * 50);
+  }
+  if (args.quit_us) add_latency((Input_key_t){S21_ESC, args.quit_us});
   pthread_cancel(thread);
   pthread_join(thread, NULL);
+  pthread_cond_destroy(&args.wake);
+}
+
+void wait_tick(Thread_args_t *args, int ms) {
+  struct timespec deadline;
+  clock_gettime(CLOCK_MONOTONIC, &deadline);
+  deadline.tv_sec += ms / 1000;
+  deadline.tv_nsec += (ms % 1000) * 1000000L;
+  if (deadline.tv_nsec >= 1000000000L) {
+    deadline.tv_sec++;
+    deadline.tv_nsec -= 1000000000L;
+  }
+
+  pthread_mutex_lock(&args->mutex);
+  while (args->running &&
+         !pthread_cond_timedwait(&args->wake, &args->mutex, &deadline))
+    ;
+  pthread_mutex_unlock(&args->mutex);
+}
+
+void stop_loop(Thread_args_t *args, long long quit_us) {
+  pthread_mutex_lock(&args->mutex);
+  args->quit_us = quit_us;
+  args->running = false;
+  pthread_cond_signal(&args->wake);
+  pthread_mutex_unlock(&args->mutex);
 }
 
 void delete_wins() {
@@ -95,14 +153,22 @@ void delete_wins() {
 void *key_listener(void *arg) {
   Thread_args_t *args = (Thread_args_t *)arg;
 
+  Input_decoder_t decoder;
+  Input_key_t keys[INPUT_MAX_KEYS];
+
+  input_init(&decoder);
   while (args->running) {
-    int ch = getch();
-    if (get_backend(ch)) {
-      if (ch == S21_ESC)
-        args->running = false;
-      else
-        update_wins();
-    }
+    int count = input_read(&decoder, STDIN_FILENO, keys);
+    for (int i = 0; i < count && args->running; i++)
+      if (get_backend(keys[i].ch)) {
+        record_key(keys[i].ch);
+        if (keys[i].ch == S21_ESC) {
+          stop_loop(args, keys[i].start_us);
+        } else {
+          update_wins();
+          add_latency(keys[i]);
+        }
+      }
   }
   return NULL;
 }
@@ -48,6 +48,7 @@
 #define KEYS_ROW 7
 
 #define S21_ENTER 10
+#define S21_CR 13
 #define S21_ESC 27
 #define S21_SPACE 32
 
@@ -58,15 +59,19 @@
     noecho();              \
     nodelay(stdscr, TRUE); \
     curs_set(0);           \
-    keypad(stdscr, TRUE);  \
+    typeahead(-1);         \
   }
 
 /**
  * @struct Thread_args_t
  * @brief Structure to hold thread arguments for managing thread state.
  *
- * This structure contains a single member:
+ * This structure contains the following members:
  * - `running`: A volatile boolean flag indicating whether the thread is active.
+ * - `mutex` and `wake`: Let the key listener wake the main loop from its sleep
+ *   when it clears the `running` flag. `wake` uses CLOCK_MONOTONIC, so wall
+ *   clock adjustments do not change the sleep time.
+ * - `quit_us`: Arrival time of the Esc key that stopped the loop.
  *
  * The `volatile` keyword is used to inform the compiler that this variable
  * may be changed by external factors (such as an interrupt or another thread),
@@ -74,6 +79,9 @@
  */
 typedef struct {
   volatile bool running;  ///< Indicates if the thread is currently running.
+  pthread_mutex_t mutex;  ///< Protects `running` while the loop sleeps.
+  pthread_cond_t wake;    ///< Signaled when `running` is cleared.
+  long long quit_us;      ///< Arrival time of the Esc key, 0 if none.
 } Thread_args_t;
 
 /**
@@ -175,12 +183,31 @@ void create_wins();
  * It creates a new thread that runs the key_listener() function, passing
  * a structure containing a boolean flag to indicate running state.
  * The loop continuously updates the window and sleeps for an interval
- * based on the game speed, until the running flag is set to false. Once the
- * loop ends, it cancels the key listener thread and waits for its termination
- * before exiting.
+ * based on the game speed, until the running flag is set to false. The sleep
+ * is interrupted as soon as the key listener stops the loop, and the latency
+ * of the Esc key is measured up to this point. Once the loop ends, it cancels
+ * the key listener thread and waits for its termination before exiting.
  */
 void loop();
 
+/**
+ * @brief Sleeps until the timeout expires or the loop is stopped.
+ *
+ * @param[in] args A pointer to the thread arguments shared with the key
+ * listener.
+ * @param[in] ms The timeout in milliseconds.
+ */
+void wait_tick(Thread_args_t *args, int ms);
+
+/**
+ * @brief Stops the main loop and wakes it from the sleep.
+ *
+ * @param[in,out] args A pointer to the thread arguments shared with the main
+ * loop.
+ * @param[in] quit_us Arrival time of the Esc key that stops the loop.
+ */
+void stop_loop(Thread_args_t *args, long long quit_us);
+
 /**
  * @brief Deletes all windows associated with the Wins_t structure.
  *
@@ -196,11 +223,14 @@ void delete_wins();
  * @brief Listens for keyboard input on a separate thread.
  *
  * This function runs in an infinite loop while the `args->running` flag is set
- * to true. It captures keyboard input using `getch()` and processes it by
- * calling `get_backend()`. If the user presses the Esc key (ASCII value 27), it
- * sets the `args->running` flag to false, which signals the listener to stop.
- * If a valid key is detected, it updates the windows by calling
- * `update_wins()`.
+ * to true. It reads the terminal input directly with `input_read()` instead of
+ * ncurses `getch()`, so a bare Esc is recognized after INPUT_ESC_TIMEOUT_MS
+ * rather than after ESCDELAY, and all keys received at once are processed in
+ * order by calling `get_backend()`. If the user presses the Esc key (ASCII
+ * value 27), it calls `stop_loop()`, which signals the listener and the main
+ * loop to stop. If a valid key is detected, it updates the windows by
+ * calling `update_wins()`. The latency of every processed key is added to the
+ * statistics with `add_latency()`.
  *
  * @param[in] arg A pointer to a `Thread_args_t` structure containing thread
  * arguments.
@@ -10,12 +10,36 @@ fi
 
 find /project/src -name 'tetris_fsm.a' -exec cp {} /brick/src/ \;
 
-cd /brick/src && make tetris_fsm.a 1>/dev/null 2>&1
+if [ -d "/project/replays" ]; then
+    cp /project/replays/*.txt /brick/src/replays/ 2>/dev/null
+fi
 
-cd /brick/src && make 1>/dev/null 2>&1
-TARGET_BUILD=$?
-if [ $TARGET_BUILD -eq 0 ]; then
-    Tetris "${TCOLOR}" "${TBRIGHT}"
-else
+TBUILD=${TBUILD:-release}
+BUILD=release
+if [ "${TBUILD}" = "debug" ]; then
+    BUILD=debug
+fi
+
+cd /brick/src && make tetris_fsm.a BUILD=$BUILD 1>/dev/null 2>&1
+
+BUILD_MODE=""
+if [ "${TBUILD}" = "pgo" ]; then
+    cd /brick/src && make pgo 1>/dev/null 2>&1 && BUILD_MODE=pgo
+fi
+if [ -z "$BUILD_MODE" ] && [ "${TBUILD}" != "debug" ]; then
+    cd /brick/src && make 1>/dev/null 2>&1 && BUILD_MODE=release
+fi
+if [ -z "$BUILD_MODE" ]; then
+    cd /brick/src && make BUILD=debug 1>/dev/null 2>&1 && BUILD_MODE=debug
+fi
+
+if [ -z "$BUILD_MODE" ]; then
     echo "Application build: FAIL"
+elif [ "$BUILD_MODE" != "${TBUILD}" ]; then
+    echo "Application build: $BUILD_MODE (${TBUILD} build failed)"
+    sleep 2
+    Tetris "${TCOLOR}" "${TBRIGHT}" "${TRECORD}" "${TLATENCY}"
+else
+    echo "Application build: $BUILD_MODE"
+    Tetris "${TCOLOR}" "${TBRIGHT}" "${TRECORD}" "${TLATENCY}"
 fi